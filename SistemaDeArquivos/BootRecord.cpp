@@ -9,15 +9,20 @@ BootRecordManager::BootRecordManager() {
     bootRecord.rootEntryCount = 0;
     bootRecord.sectorsPerFAT = 0;
     strncpy(bootRecord.volumeLabel, "FAT", 4);
+    bootRecord.stripeCount = 0;
+    bootRecord.stripeClusters = STRIPE_CLUSTERS_DEFAULT;
+    bootRecord.reserved = 0;
+    bootRecord.totalSectors = 0;
 }
 
 // Função para formatar o sistema de arquivos
-void BootRecordManager::format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster) {
+void BootRecordManager::format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster, uint8_t stripeCount) {
     // Configura os campos do Boot Record
     bootRecord.bytesPerSector = BYTES_PER_SECTOR_DEFAULT;
     bootRecord.sectorsPerCluster = sectorsPerCluster;
     bootRecord.numberOfFATs = 1; // Simplificação: apenas uma FAT
     bootRecord.rootEntryCount = rootEntryCount;
+    bootRecord.totalSectors = totalSectors;
 
     // Calcular o número de setores ocupados pelo Root Directory
     uint32_t rootDirSectors = (rootEntryCount * 32 + BYTES_PER_SECTOR_DEFAULT - 1) / BYTES_PER_SECTOR_DEFAULT;
@@ -35,6 +40,10 @@ void BootRecordManager::format(uint32_t totalSectors, uint16_t rootEntryCount, u
 
     // Definir o rótulo do volume
     strncpy(bootRecord.volumeLabel, "FAT", 4);
+
+    // Registrar o mapeamento cluster -> imagem da Área de Dados distribuída
+    bootRecord.stripeCount = stripeCount;
+    bootRecord.stripeClusters = STRIPE_CLUSTERS_DEFAULT;
 }
 
 // Retorna o Boot Record
@@ -4,14 +4,18 @@
 #include <cstdint>
 #include <cstdio>
 
-// Estrutura do Boot Record (12 bytes)
+// Estrutura do Boot Record (20 bytes)
 struct BootRecord {
     uint16_t bytesPerSector;    // Bytes por setor (2 bytes)
     uint8_t sectorsPerCluster;  // Setores por cluster (1 byte)
     uint8_t numberOfFATs;       // Número de FATs (1 byte)
     uint16_t rootEntryCount;    // Número de entradas no diretório raiz (2 bytes)
     uint16_t sectorsPerFAT;     // Setores por FAT (2 bytes)
-    char volumeLabel[4];        // Rótulo do volume (4 bytes para totalizar 12 bytes)
+    char volumeLabel[4];        // Rótulo do volume (4 bytes)
+    uint8_t stripeCount;        // Número de imagens em que a Área de Dados é distribuída, 0 = imagem principal (1 byte)
+    uint8_t stripeClusters;     // Clusters consecutivos gravados em cada imagem antes de passar à próxima (1 byte)
+    uint16_t reserved;          // Reservado (2 bytes)
+    uint32_t totalSectors;      // Tamanho da partição em setores, usado ao montar (4 bytes)
 };
 
 class BootRecordManager {
@@ -20,7 +24,7 @@ public:
     BootRecordManager();
 
     // Função para formatar o sistema de arquivos
-    void format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster);
+    void format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster, uint8_t stripeCount);
 
     // Obter o Boot Record
     BootRecord getBootRecord() const;
@@ -34,6 +38,7 @@ public:
 private:
     BootRecord bootRecord;
     static const uint16_t BYTES_PER_SECTOR_DEFAULT = 512; // Valor padrão para bytes por setor
+    static const uint8_t STRIPE_CLUSTERS_DEFAULT = 8;     // Valor padrão para a unidade de distribuição
 };
 
 #endif // BOOT_RECORD_H
\ No newline at end of file
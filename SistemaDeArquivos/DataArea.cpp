@@ -1,5 +1,7 @@
 #include "DataArea.h"
 #include <cstring>
+#include <thread>
+#include <algorithm>
 
 // Construtor: inicializa a Área de Dados com o tamanho do cluster e o número de clusters
 DataAreaManager::DataAreaManager(uint32_t clusterSize, uint32_t clusterCount) {
@@ -18,6 +20,17 @@ void DataAreaManager::writeData(uint16_t cluster, const char* data, uint32_t siz
     memcpy(dataArea.data() + offset, data, size);
 }
 
+// Escreve uma sequência de clusters contíguos de uma só vez
+void DataAreaManager::writeClusters(uint16_t firstCluster, uint32_t count, const char* data, uint32_t size) {
+    if (count == 0 || firstCluster >= clusterCount) {
+        return; // Faixa inválida
+    }
+    count = std::min<uint32_t>(count, clusterCount - firstCluster); // Escrever apenas a parte válida da faixa
+    uint32_t offset = firstCluster * clusterSize;
+    size = std::min(size, count * clusterSize); // Não escrever além da faixa pedida
+    memcpy(dataArea.data() + offset, data, size);
+}
+
 // Lê dados de um cluster específico
 void DataAreaManager::readData(uint16_t cluster, char* buffer, uint32_t size) const {
     if (cluster >= clusterCount) {
@@ -29,6 +42,39 @@ void DataAreaManager::readData(uint16_t cluster, char* buffer, uint32_t size) co
     memcpy(buffer, dataArea.data() + offset, size);
 }
 
+// Escreve dados a partir de um deslocamento dentro de um cluster (fatias de cauda)
+void DataAreaManager::writeDataAt(uint16_t cluster, uint32_t offset, const char* data, uint32_t size) {
+    if (cluster >= clusterCount || offset >= clusterSize) {
+        return; // Cluster ou deslocamento inválido
+    }
+    size = std::min(size, clusterSize - offset); // Não escrever além do fim do cluster
+    memcpy(dataArea.data() + cluster * clusterSize + offset, data, size);
+}
+
+// Lê dados a partir de um deslocamento dentro de um cluster (fatias de cauda)
+void DataAreaManager::readDataAt(uint16_t cluster, uint32_t offset, char* buffer, uint32_t size) const {
+    if (cluster >= clusterCount || offset >= clusterSize) {
+        memset(buffer, 0, size); // Cluster ou deslocamento inválido, preenche com zeros
+        return;
+    }
+    size = std::min(size, clusterSize - offset); // Não ler além do fim do cluster
+    memcpy(buffer, dataArea.data() + cluster * clusterSize + offset, size);
+}
+
+// Lê uma sequência de clusters contíguos de uma só vez (sequências contíguas de uma cadeia)
+void DataAreaManager::readClusters(uint16_t firstCluster, uint32_t count, char* buffer, uint32_t size) const {
+    if (count == 0 || firstCluster >= clusterCount) {
+        memset(buffer, 0, size); // Cluster inicial inválido, preenche com zeros
+        return;
+    }
+    size = std::min(size, count * clusterSize); // Não ler além da faixa pedida
+
+    // Ler apenas os clusters que existem; só o trecho além do fim da Área de Dados fica zerado
+    uint32_t validSize = std::min(size, (clusterCount - firstCluster) * clusterSize);
+    memcpy(buffer, dataArea.data() + firstCluster * clusterSize, validSize);
+    memset(buffer + validSize, 0, size - validSize);
+}
+
 // Obtém o tamanho de um cluster
 uint32_t DataAreaManager::getClusterSize() const {
     return clusterSize;
@@ -49,4 +95,135 @@ void DataAreaManager::saveToDisk(FILE* disk, uint32_t offset) {
 void DataAreaManager::loadFromDisk(FILE* disk, uint32_t offset) {
     fseek(disk, offset, SEEK_SET);
     fread(dataArea.data(), sizeof(char), dataArea.size(), disk);
+}
+
+// Lista, em ordem, os clusters que ficam na imagem de índice stripe
+// Os clusters são distribuídos em blocos de stripeClusters: bloco 0 na imagem 0, bloco 1 na imagem 1, ...
+std::vector<uint32_t> DataAreaManager::stripeClusterList(uint32_t stripe, uint32_t stripeCount, uint32_t stripeClusters) const {
+    std::vector<uint32_t> clusters;
+    for (uint32_t first = stripe * stripeClusters; first < clusterCount; first += stripeCount * stripeClusters) {
+        for (uint32_t cluster = first; cluster < first + stripeClusters && cluster < clusterCount; ++cluster) {
+            clusters.push_back(cluster);
+        }
+    }
+    return clusters;
+}
+
+// Salva a Área de Dados distribuída entre várias imagens, gravando todas em paralelo
+void DataAreaManager::saveToStripes(const std::vector<FILE*>& stripes, uint8_t stripeClusters) {
+    std::vector<std::thread> workers;
+    for (uint32_t stripe = 0; stripe < stripes.size(); ++stripe) {
+        workers.emplace_back([this, &stripes, stripe, stripeClusters]() {
+            // Juntar os clusters desta imagem em um único buffer e gravá-lo de uma vez
+            std::vector<uint32_t> clusters = stripeClusterList(stripe, stripes.size(), stripeClusters);
+            std::vector<char> buffer(clusters.size() * clusterSize);
+            for (size_t i = 0; i < clusters.size(); ++i) {
+                memcpy(buffer.data() + i * clusterSize, dataArea.data() + clusters[i] * clusterSize, clusterSize);
+            }
+            fseek(stripes[stripe], 0, SEEK_SET);
+            fwrite(buffer.data(), sizeof(char), buffer.size(), stripes[stripe]);
+            fflush(stripes[stripe]);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Carrega a Área de Dados distribuída entre várias imagens, lendo todas em paralelo
+void DataAreaManager::loadFromStripes(const std::vector<FILE*>& stripes, uint8_t stripeClusters) {
+    std::vector<std::thread> workers;
+    for (uint32_t stripe = 0; stripe < stripes.size(); ++stripe) {
+        workers.emplace_back([this, &stripes, stripe, stripeClusters]() {
+            // Ler a imagem inteira de uma vez e espalhar os clusters nas suas posições
+            std::vector<uint32_t> clusters = stripeClusterList(stripe, stripes.size(), stripeClusters);
+            std::vector<char> buffer(clusters.size() * clusterSize, 0);
+            fseek(stripes[stripe], 0, SEEK_SET);
+            fread(buffer.data(), sizeof(char), buffer.size(), stripes[stripe]);
+            for (size_t i = 0; i < clusters.size(); ++i) {
+                memcpy(dataArea.data() + clusters[i] * clusterSize, buffer.data() + i * clusterSize, clusterSize);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Grava no arquivo as sequências contíguas de clusters; positions[i] é a posição do cluster clusters[i] no arquivo
+void DataAreaManager::writeRuns(FILE* file, uint32_t offset, const std::vector<uint32_t>& clusters, const std::vector<uint32_t>& positions) {
+    std::vector<char> buffer;
+    for (size_t i = 0; i < clusters.size();) {
+        // Agrupar os clusters cujas posições no arquivo são consecutivas
+        size_t run = 1;
+        while (i + run < clusters.size() && positions[i + run] == positions[i] + run) {
+            ++run;
+        }
+        buffer.resize(run * clusterSize);
+        for (size_t j = 0; j < run; ++j) {
+            memcpy(buffer.data() + j * clusterSize, dataArea.data() + clusters[i + j] * clusterSize, clusterSize);
+        }
+        fseek(file, offset + positions[i] * clusterSize, SEEK_SET);
+        fwrite(buffer.data(), sizeof(char), buffer.size(), file);
+        i += run;
+    }
+    fflush(file);
+}
+
+// Salva apenas os clusters indicados no disco, a partir do offset da Área de Dados
+void DataAreaManager::saveClustersToDisk(FILE* disk, uint32_t offset, const std::vector<uint16_t>& clusters) {
+    std::vector<uint32_t> sorted;
+    for (uint16_t cluster : clusters) {
+        if (cluster < clusterCount) {
+            sorted.push_back(cluster);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    writeRuns(disk, offset, sorted, sorted);
+}
+
+// Salva apenas os clusters indicados nas imagens da Área de Dados, uma thread por imagem envolvida
+void DataAreaManager::saveClustersToStripes(const std::vector<FILE*>& stripes, uint8_t stripeClusters, const std::vector<uint16_t>& clusters) {
+    // Separar os clusters por imagem, com a posição de cada um dentro da imagem
+    uint32_t stripeCount = stripes.size();
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> perStripe(stripeCount); // (posição na imagem, cluster)
+    for (uint16_t cluster : clusters) {
+        if (cluster >= clusterCount) {
+            continue;
+        }
+        uint32_t block = cluster / stripeClusters;
+        uint32_t position = (block / stripeCount) * stripeClusters + cluster % stripeClusters;
+        perStripe[block % stripeCount].push_back(std::make_pair(position, cluster));
+    }
+
+    // Gravar cada imagem envolvida em paralelo
+    auto writeStripe = [this, &stripes, &perStripe](uint32_t stripe) {
+        auto& entries = perStripe[stripe];
+        std::sort(entries.begin(), entries.end());
+        entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+        std::vector<uint32_t> stripeClusterIds, positions;
+        for (const auto& entry : entries) {
+            positions.push_back(entry.first);
+            stripeClusterIds.push_back(entry.second);
+        }
+        writeRuns(stripes[stripe], 0, stripeClusterIds, positions);
+    };
+    std::vector<uint32_t> involved;
+    for (uint32_t stripe = 0; stripe < stripeCount; ++stripe) {
+        if (!perStripe[stripe].empty()) {
+            involved.push_back(stripe);
+        }
+    }
+    if (involved.size() == 1) {
+        writeStripe(involved[0]); // Uma só imagem: sem custo de criar thread
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (uint32_t stripe : involved) {
+        workers.emplace_back(writeStripe, stripe);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
 }
\ No newline at end of file
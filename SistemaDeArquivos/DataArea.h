@@ -13,9 +13,21 @@ public:
     // Escreve dados em um cluster específico
     void writeData(uint16_t cluster, const char* data, uint32_t size);
 
+    // Escreve uma sequência de clusters contíguos de uma só vez
+    void writeClusters(uint16_t firstCluster, uint32_t count, const char* data, uint32_t size);
+
     // Lê dados de um cluster específico
     void readData(uint16_t cluster, char* buffer, uint32_t size) const;
 
+    // Escreve dados a partir de um deslocamento dentro de um cluster (fatias de cauda)
+    void writeDataAt(uint16_t cluster, uint32_t offset, const char* data, uint32_t size);
+
+    // Lê dados a partir de um deslocamento dentro de um cluster (fatias de cauda)
+    void readDataAt(uint16_t cluster, uint32_t offset, char* buffer, uint32_t size) const;
+
+    // Lê uma sequência de clusters contíguos de uma só vez (sequências contíguas de uma cadeia)
+    void readClusters(uint16_t firstCluster, uint32_t count, char* buffer, uint32_t size) const;
+
     // Obtém o tamanho de um cluster
     uint32_t getClusterSize() const;
 
@@ -28,10 +40,28 @@ public:
     // Carrega a Área de Dados do disco a partir de um offset
     void loadFromDisk(FILE* disk, uint32_t offset);
 
+    // Salva a Área de Dados distribuída entre várias imagens, gravando todas em paralelo
+    void saveToStripes(const std::vector<FILE*>& stripes, uint8_t stripeClusters);
+
+    // Carrega a Área de Dados distribuída entre várias imagens, lendo todas em paralelo
+    void loadFromStripes(const std::vector<FILE*>& stripes, uint8_t stripeClusters);
+
+    // Salva apenas os clusters indicados no disco, a partir do offset da Área de Dados
+    void saveClustersToDisk(FILE* disk, uint32_t offset, const std::vector<uint16_t>& clusters);
+
+    // Salva apenas os clusters indicados nas imagens da Área de Dados, uma thread por imagem envolvida
+    void saveClustersToStripes(const std::vector<FILE*>& stripes, uint8_t stripeClusters, const std::vector<uint16_t>& clusters);
+
 private:
     std::vector<char> dataArea;  // Vetor que representa a Área de Dados
     uint32_t clusterSize;        // Tamanho de um cluster em bytes
     uint32_t clusterCount;       // Número total de clusters
+
+    // Lista, em ordem, os clusters que ficam na imagem de índice stripe
+    std::vector<uint32_t> stripeClusterList(uint32_t stripe, uint32_t stripeCount, uint32_t stripeClusters) const;
+
+    // Grava no arquivo as sequências contíguas de clusters; positions[i] é a posição do cluster clusters[i] no arquivo
+    void writeRuns(FILE* file, uint32_t offset, const std::vector<uint32_t>& clusters, const std::vector<uint32_t>& positions);
 };
 
 #endif // DATA_AREA_H
\ No newline at end of file
@@ -1,9 +1,21 @@
 #include "FAT.h"
+#include <cstring>
+#include <algorithm>
 using namespace std;
 
+// Obtém a faixa do histograma para uma sequência livre de tamanho length (piso de log2)
+static uint32_t freeRunBucket(uint32_t length) {
+    uint32_t bucket = 0;
+    while (length >>= 1) {
+        ++bucket;
+    }
+    return min(bucket, FREE_RUN_BUCKETS - 1);
+}
+
 // Construtor: inicializa a FAT com o número de clusters
 FATManager::FATManager(uint32_t clusterCount) {
     fatTable.resize(clusterCount, CLUSTER_FREE);
+    rebuildSummary();
 }
 
 // Inicializa a FAT (todos os clusters livres)
@@ -11,25 +23,152 @@ void FATManager::initialize() {
     for (auto& entry : fatTable) {
         entry = CLUSTER_FREE;
     }
+    rebuildSummary();
+}
+
+// Reconstrói o resumo do espaço livre varrendo toda a FAT
+void FATManager::rebuildSummary() {
+    memset(&summary, 0, sizeof(FreeSpaceSummary));
+    summary.magic = FREE_SUMMARY_MAGIC;
+    summary.regionSize = max<uint32_t>(1, (fatTable.size() + FREE_SUMMARY_REGIONS - 1) / FREE_SUMMARY_REGIONS);
+    if (!fatTable.empty()) {
+        accountFreeRuns(0, fatTable.size() - 1, 1);
+    }
+    updateRegionMaxRun(0, FREE_SUMMARY_REGIONS - 1);
+}
+
+// Soma (delta = 1) ou subtrai (delta = -1) do resumo as sequências livres dentro de [first, last]
+void FATManager::accountFreeRuns(uint32_t first, uint32_t last, int delta) {
+    uint32_t runLength = 0;
+    for (uint32_t i = first; i <= last; ++i) {
+        if (fatTable[i] == CLUSTER_FREE) {
+            summary.freeClusters += delta;
+            summary.regionFree[i / summary.regionSize] += delta;
+            ++runLength;
+        }
+        // Fim de uma sequência livre: registrar o tamanho no histograma
+        if ((fatTable[i] != CLUSTER_FREE || i == last) && runLength > 0) {
+            summary.freeRunHistogram[freeRunBucket(runLength)] += delta;
+            runLength = 0;
+        }
+    }
+}
+
+// Recalcula a maior sequência livre que começa em cada região de firstRegion a lastRegion
+// Uma sequência que começa no fim de uma região e continua nas seguintes conta só para a região onde começa
+void FATManager::updateRegionMaxRun(uint32_t firstRegion, uint32_t lastRegion) {
+    for (uint32_t region = firstRegion; region <= lastRegion; ++region) {
+        uint32_t begin = region * summary.regionSize;
+        uint32_t end = min<uint32_t>(begin + summary.regionSize, fatTable.size());
+        uint32_t maxRun = 0;
+        uint32_t i = begin;
+
+        // Pular a sequência livre que começou na região anterior
+        while (i > 0 && i < end && fatTable[i - 1] == CLUSTER_FREE && fatTable[i] == CLUSTER_FREE) {
+            ++i;
+        }
+        while (i < end) {
+            if (fatTable[i] != CLUSTER_FREE) {
+                ++i;
+                continue;
+            }
+            uint32_t runEnd = i;
+            while (runEnd < fatTable.size() && fatTable[runEnd] == CLUSTER_FREE) {
+                ++runEnd;
+            }
+            maxRun = max(maxRun, runEnd - i);
+            i = runEnd;
+        }
+        summary.regionMaxRun[region] = maxRun;
+    }
+}
+
+// Retira do resumo a faixa [first, last], estendida até as bordas das sequências livres vizinhas
+// Deve ser chamada antes de alterar clusters dentro da faixa
+void FATManager::beginSummaryUpdate(uint32_t& first, uint32_t& last) {
+    while (first > 0 && fatTable[first - 1] == CLUSTER_FREE) {
+        --first;
+    }
+    while (last + 1 < fatTable.size() && fatTable[last + 1] == CLUSTER_FREE) {
+        ++last;
+    }
+    accountFreeRuns(first, last, -1);
+}
+
+// Devolve ao resumo a faixa [first, last] retornada por beginSummaryUpdate, já alterada
+void FATManager::endSummaryUpdate(uint32_t first, uint32_t last) {
+    accountFreeRuns(first, last, 1);
+    // Só as sequências que começam nas regiões da faixa podem ter mudado
+    updateRegionMaxRun(first / summary.regionSize, last / summary.regionSize);
+}
+
+// Procura a primeira sequência contígua de clusters livres; retorna false se não existir
+bool FATManager::findContiguousRun(uint32_t clusterCount, uint32_t& start) const {
+    // A primeira região onde começa uma sequência livre grande o bastante contém a primeira sequência que serve
+    for (uint32_t region = 0; region < FREE_SUMMARY_REGIONS; ++region) {
+        if (summary.regionMaxRun[region] < clusterCount) {
+            continue; // Pular a região sem varrer a FAT
+        }
+        uint32_t begin = region * summary.regionSize;
+        uint32_t end = min<uint32_t>(begin + summary.regionSize, fatTable.size());
+        uint32_t i = begin;
+
+        // Pular a sequência livre que começou na região anterior
+        while (i > 0 && i < end && fatTable[i - 1] == CLUSTER_FREE && fatTable[i] == CLUSTER_FREE) {
+            ++i;
+        }
+        while (i < end) {
+            if (fatTable[i] != CLUSTER_FREE) {
+                ++i;
+                continue;
+            }
+            uint32_t runEnd = i;
+            while (runEnd < fatTable.size() && fatTable[runEnd] == CLUSTER_FREE && runEnd - i < clusterCount) {
+                ++runEnd;
+            }
+            if (runEnd - i == clusterCount) {
+                start = i;
+                return true;
+            }
+            i = runEnd;
+        }
+    }
+    return false;
 }
 
-// Aloca um número de clusters para um arquivo
+// Aloca um número de clusters para um arquivo (prefere uma única sequência contígua)
 vector<uint16_t> FATManager::allocateClusters(uint32_t clusterCount) {
     vector<uint16_t> allocatedClusters;
 
-    // Procurar clusters livres
-    for (uint32_t i = 0; i < fatTable.size() && allocatedClusters.size() < clusterCount; ++i) {
-        if (fatTable[i] == CLUSTER_FREE) {
+    uint32_t start;
+    if (clusterCount > 0 && findContiguousRun(clusterCount, start)) {
+        // Há uma sequência contígua grande o bastante: o arquivo fica sem fragmentação
+        for (uint32_t i = start; i < start + clusterCount; ++i) {
             allocatedClusters.push_back(i);
         }
+    } else if (summary.freeClusters >= clusterCount) {
+        // Procurar clusters livres em qualquer posição, pulando as regiões cheias
+        for (uint32_t i = 0; i < fatTable.size() && allocatedClusters.size() < clusterCount; ++i) {
+            if (i % summary.regionSize == 0 && summary.regionFree[i / summary.regionSize] == 0) {
+                i += summary.regionSize - 1;
+                continue;
+            }
+            if (fatTable[i] == CLUSTER_FREE) {
+                allocatedClusters.push_back(i);
+            }
+        }
     }
 
     // Verificar se há clusters suficientes
-    if (allocatedClusters.size() < clusterCount) {
+    if (allocatedClusters.empty() || allocatedClusters.size() < clusterCount) {
         allocatedClusters.clear(); // Não há espaço suficiente
         return allocatedClusters;
     }
 
+    uint32_t first = allocatedClusters.front();
+    uint32_t last = allocatedClusters.back();
+    beginSummaryUpdate(first, last);
+
     // Criar a cadeia de clusters
     for (size_t i = 0; i < allocatedClusters.size() - 1; ++i) {
         fatTable[allocatedClusters[i]] = allocatedClusters[i + 1];
@@ -38,18 +177,31 @@ vector<uint16_t> FATManager::allocateClusters(uint32_t clusterCount) {
     if (!allocatedClusters.empty()) {
         fatTable[allocatedClusters.back()] = CLUSTER_EOF;
     }
+    endSummaryUpdate(first, last);
 
     return allocatedClusters;
 }
 
 // Libera os clusters de um arquivo a partir do cluster inicial
 void FATManager::freeClusters(uint16_t startCluster) {
+    // Percorrer a cadeia antes de alterá-la para saber a faixa afetada no resumo
+    vector<uint16_t> chain;
     uint16_t currentCluster = startCluster;
-    while (currentCluster != CLUSTER_EOF && currentCluster < fatTable.size()) {
-        uint16_t nextCluster = fatTable[currentCluster];
-        fatTable[currentCluster] = CLUSTER_FREE;
-        currentCluster = nextCluster;
+    while (currentCluster != CLUSTER_EOF && currentCluster < fatTable.size() && chain.size() < fatTable.size()) {
+        chain.push_back(currentCluster);
+        currentCluster = fatTable[currentCluster];
+    }
+    if (chain.empty()) {
+        return;
     }
+
+    uint32_t first = *min_element(chain.begin(), chain.end());
+    uint32_t last = *max_element(chain.begin(), chain.end());
+    beginSummaryUpdate(first, last);
+    for (uint16_t cluster : chain) {
+        fatTable[cluster] = CLUSTER_FREE;
+    }
+    endSummaryUpdate(first, last);
 }
 
 // Obtém o próximo cluster na cadeia
@@ -62,9 +214,19 @@ uint16_t FATManager::getNextCluster(uint16_t cluster) const {
 
 // Define o próximo cluster na cadeia
 void FATManager::setNextCluster(uint16_t cluster, uint16_t nextCluster) {
-    if (cluster < fatTable.size()) {
+    if (cluster >= fatTable.size()) {
+        return;
+    }
+    // O resumo só muda quando o cluster passa de livre para ocupado ou vice-versa
+    if ((fatTable[cluster] == CLUSTER_FREE) == (nextCluster == CLUSTER_FREE)) {
         fatTable[cluster] = nextCluster;
+        return;
     }
+    uint32_t first = cluster;
+    uint32_t last = cluster;
+    beginSummaryUpdate(first, last);
+    fatTable[cluster] = nextCluster;
+    endSummaryUpdate(first, last);
 }
 
 // Salva a FAT no disco a partir de um offset
@@ -79,7 +241,41 @@ void FATManager::loadFromDisk(FILE* disk, uint32_t offset) {
     fread(fatTable.data(), sizeof(uint16_t), fatTable.size(), disk);
 }
 
+// Salva o resumo do espaço livre no disco a partir de um offset
+void FATManager::saveSummaryToDisk(FILE* disk, uint32_t offset) {
+    fseek(disk, offset, SEEK_SET);
+    fwrite(&summary, sizeof(FreeSpaceSummary), 1, disk);
+}
+
+// Salva a FAT e o resumo do espaço livre: o resumo é invalidado no disco antes da gravação da FAT
+// e regravado depois dela, então um resumo válido no disco sempre corresponde à FAT salva
+void FATManager::saveWithSummaryToDisk(FILE* disk, uint32_t fatOffset, uint32_t summaryOffset) {
+    uint32_t invalidMagic = 0;
+    fseek(disk, summaryOffset, SEEK_SET);
+    fwrite(&invalidMagic, sizeof(uint32_t), 1, disk);
+    fflush(disk);
+    saveToDisk(disk, fatOffset);
+    fflush(disk);
+    saveSummaryToDisk(disk, summaryOffset);
+}
+
+// Carrega o resumo do espaço livre do disco (a FAT já deve estar carregada)
+// Se o resumo não existir ou tiver sido invalidado, reconstrói a partir da FAT
+void FATManager::loadSummaryFromDisk(FILE* disk, uint32_t offset) {
+    fseek(disk, offset, SEEK_SET);
+    uint32_t expectedRegionSize = max<uint32_t>(1, (fatTable.size() + FREE_SUMMARY_REGIONS - 1) / FREE_SUMMARY_REGIONS);
+    if (fread(&summary, sizeof(FreeSpaceSummary), 1, disk) != 1 || summary.magic != FREE_SUMMARY_MAGIC ||
+        summary.regionSize != expectedRegionSize) {
+        rebuildSummary(); // Disco antigo, resumo corrompido ou queda durante a gravação da FAT
+    }
+}
+
 // Obtém o número total de clusters
 uint32_t FATManager::getClusterCount() const {
     return fatTable.size();
+}
+
+// Obtém o resumo do espaço livre (mantido a cada alocação e liberação, sem varrer a FAT)
+const FreeSpaceSummary& FATManager::getFreeSpaceSummary() const {
+    return summary;
 }
\ No newline at end of file
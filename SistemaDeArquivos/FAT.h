@@ -9,6 +9,24 @@
 const uint16_t CLUSTER_FREE = 0x0000;  // Cluster livre
 const uint16_t CLUSTER_EOF = 0xFFFF;   // Fim de arquivo
 const uint16_t CLUSTER_BAD = 0xFFF7;   // Cluster defeituoso
+const uint16_t CLUSTER_PACKED = 0xFFF6; // Cluster compartilhado por arquivos pequenos (fatias de cauda)
+
+// Resumo do espaço livre, gravado no setor do Boot Record logo após a estrutura do Boot Record
+const uint32_t FREE_SUMMARY_MAGIC = 0x46524545;  // "FREE": identifica um resumo válido no disco
+const uint32_t FREE_SUMMARY_OFFSET = 64;         // Offset do resumo dentro do setor 0
+const uint32_t FREE_RUN_BUCKETS = 16;            // Faixas do histograma de sequências livres
+const uint32_t FREE_SUMMARY_REGIONS = 32;        // Regiões da FAT com contagem própria de clusters livres
+
+// Estrutura do resumo do espaço livre (336 bytes)
+struct FreeSpaceSummary {
+    uint32_t magic;                                // Marcador de resumo válido (4 bytes)
+    uint32_t freeClusters;                         // Total de clusters livres (4 bytes)
+    uint32_t regionSize;                           // Clusters por região (4 bytes)
+    uint32_t reserved;                             // Reservado (4 bytes)
+    uint32_t freeRunHistogram[FREE_RUN_BUCKETS];   // Faixa k: sequências livres com tamanho em [2^k, 2^(k+1)) (64 bytes)
+    uint32_t regionFree[FREE_SUMMARY_REGIONS];     // Clusters livres em cada região (128 bytes)
+    uint32_t regionMaxRun[FREE_SUMMARY_REGIONS];   // Maior sequência livre que começa em cada região (128 bytes)
+};
 
 class FATManager {
 public:
@@ -18,7 +36,7 @@ public:
     // Inicializa a FAT (todos os clusters livres)
     void initialize();
 
-    // Aloca um número de clusters para um arquivo
+    // Aloca um número de clusters para um arquivo (prefere uma única sequência contígua)
     std::vector<uint16_t> allocateClusters(uint32_t clusterCount);
 
     // Libera os clusters de um arquivo a partir do cluster inicial
@@ -36,11 +54,45 @@ public:
     // Carrega a FAT do disco a partir de um offset
     void loadFromDisk(FILE* disk, uint32_t offset);
 
+    // Salva o resumo do espaço livre no disco a partir de um offset
+    void saveSummaryToDisk(FILE* disk, uint32_t offset);
+
+    // Salva a FAT e o resumo do espaço livre: o resumo é invalidado no disco antes da gravação da FAT
+    // e regravado depois dela, então um resumo válido no disco sempre corresponde à FAT salva
+    void saveWithSummaryToDisk(FILE* disk, uint32_t fatOffset, uint32_t summaryOffset);
+
+    // Carrega o resumo do espaço livre do disco (a FAT já deve estar carregada)
+    // Se o resumo não existir ou tiver sido invalidado, reconstrói a partir da FAT
+    void loadSummaryFromDisk(FILE* disk, uint32_t offset);
+
     // Obtém o número total de clusters
     uint32_t getClusterCount() const;
 
+    // Obtém o resumo do espaço livre (mantido a cada alocação e liberação, sem varrer a FAT)
+    const FreeSpaceSummary& getFreeSpaceSummary() const;
+
 private:
     std::vector<uint16_t> fatTable;  // Tabela FAT (vetor de entradas de 16 bits)
+    FreeSpaceSummary summary;        // Resumo do espaço livre
+
+    // Reconstrói o resumo do espaço livre varrendo toda a FAT
+    void rebuildSummary();
+
+    // Retira do resumo a faixa [first, last], estendida até as bordas das sequências livres vizinhas
+    // Deve ser chamada antes de alterar clusters dentro da faixa
+    void beginSummaryUpdate(uint32_t& first, uint32_t& last);
+
+    // Devolve ao resumo a faixa [first, last] retornada por beginSummaryUpdate, já alterada
+    void endSummaryUpdate(uint32_t first, uint32_t last);
+
+    // Soma (delta = 1) ou subtrai (delta = -1) do resumo as sequências livres dentro de [first, last]
+    void accountFreeRuns(uint32_t first, uint32_t last, int delta);
+
+    // Recalcula a maior sequência livre que começa em cada região de firstRegion a lastRegion
+    void updateRegionMaxRun(uint32_t firstRegion, uint32_t lastRegion);
+
+    // Procura a primeira sequência contígua de clusters livres; retorna false se não existir
+    bool findContiguousRun(uint32_t clusterCount, uint32_t& start) const;
 };
 
 #endif // FAT_H
\ No newline at end of file
@@ -2,16 +2,44 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <map>
 
-FileSystem::FileSystem(const std::string& diskPath) {
-    // Abrir o arquivo que simula o disco
-    disk = fopen(diskPath.c_str(), "wb+");
+FileSystem::FileSystem(const std::string& diskPath) : FileSystem(diskPath, std::vector<std::string>()) {
+}
+
+FileSystem::FileSystem(const std::string& diskPath, const std::vector<std::string>& stripePaths) {
+    // Abrir o arquivo que simula o disco (sem apagar o conteúdo, para que possa ser montado)
+    disk = fopen(diskPath.c_str(), "rb+");
+    if (!disk) {
+        disk = fopen(diskPath.c_str(), "wb+");
+    }
     if (!disk) {
         throw std::runtime_error("Erro ao abrir o disco!");
     }
     fat = nullptr;
     rootDir = nullptr;
     dataArea = nullptr;
+    trace = nullptr;
+
+    // Abrir as imagens que recebem a Área de Dados distribuída
+    if (stripePaths.size() > 255) {
+        fclose(disk);
+        throw std::runtime_error("Número de imagens da Área de Dados maior que 255!");
+    }
+    for (const auto& stripePath : stripePaths) {
+        FILE* stripe = fopen(stripePath.c_str(), "rb+");
+        if (!stripe) {
+            stripe = fopen(stripePath.c_str(), "wb+");
+        }
+        if (!stripe) {
+            for (FILE* opened : stripes) {
+                fclose(opened);
+            }
+            fclose(disk);
+            throw std::runtime_error("Erro ao abrir a imagem " + stripePath + "!");
+        }
+        stripes.push_back(stripe);
+    }
 }
 
 FileSystem::~FileSystem() {
@@ -20,6 +48,9 @@ FileSystem::~FileSystem() {
     delete rootDir;
     delete dataArea;
 
+    for (FILE* stripe : stripes) {
+        fclose(stripe);
+    }
     if (disk) {
         fclose(disk);
     }
@@ -27,8 +58,11 @@ FileSystem::~FileSystem() {
 
 bool FileSystem::format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster) {
     // Formatar o Boot Record
-    bootRecord.format(totalSectors, rootEntryCount, sectorsPerCluster);
+    bootRecord.format(totalSectors, rootEntryCount, sectorsPerCluster, stripes.size());
     bootRecord.saveToDisk(disk);
+    if (trace) {
+        trace->recordFormat(totalSectors, rootEntryCount, sectorsPerCluster, stripes.size());
+    }
 
     // Calcular o número de clusters
     uint32_t rootDirSectors = (rootEntryCount * 32 + 511) / 512; // Cada entrada do Root Directory ocupa 32 bytes, e o resultado é arredondado para o número de setores (dividindo por 512 bytes por setor)
@@ -41,7 +75,7 @@ bool FileSystem::format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t
     fat = new FATManager(clusterCount);
     fat->initialize();
     uint32_t fatOffset = 512; // Após o Boot Record (setor 1)
-    fat->saveToDisk(disk, fatOffset);
+    fat->saveWithSummaryToDisk(disk, fatOffset, FREE_SUMMARY_OFFSET);
 
     // Inicializar o Root Directory
     delete rootDir;
@@ -55,13 +89,86 @@ bool FileSystem::format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t
     uint32_t clusterSize = 512 * sectorsPerCluster; // 512 bytes por setor
     dataArea = new DataAreaManager(clusterSize, clusterCount);
     uint32_t dataAreaOffset = rootDirOffset + (rootEntryCount * 32);
-    dataArea->saveToDisk(disk, dataAreaOffset);
+    saveDataArea(dataAreaOffset);
 
     return true;
 }
 
+// Monta um sistema de arquivos já formatado, carregando as estruturas do disco
+bool FileSystem::mount() {
+    // Carregar e validar o Boot Record
+    bootRecord.loadFromDisk(disk);
+    BootRecord br = bootRecord.getBootRecord();
+    if (strncmp(br.volumeLabel, "FAT", 4) != 0 || br.bytesPerSector != 512 || br.sectorsPerCluster == 0 ||
+        br.totalSectors == 0) {
+        std::cerr << "A imagem não contém um sistema de arquivos formatado!" << std::endl;
+        return false;
+    }
+    if (br.stripeCount != stripes.size()) {
+        std::cerr << "A imagem usa " << static_cast<int>(br.stripeCount) << " imagens para a Área de Dados!" << std::endl;
+        return false;
+    }
+    if (trace) {
+        trace->recordFormat(br.totalSectors, br.rootEntryCount, br.sectorsPerCluster, br.stripeCount);
+    }
+
+    // Calcular o número de clusters (mesma conta da formatação)
+    uint32_t rootDirSectors = (br.rootEntryCount * 32 + 511) / 512;
+    uint32_t reservedSectors = 1; // Boot Record
+    uint32_t dataSectors = br.totalSectors - reservedSectors - rootDirSectors;
+    uint32_t clusterCount = dataSectors / br.sectorsPerCluster;
+
+    // Carregar a FAT
+    delete fat;
+    fat = new FATManager(clusterCount);
+    uint32_t fatOffset = 512;
+    fat->loadFromDisk(disk, fatOffset);
+    fat->loadSummaryFromDisk(disk, FREE_SUMMARY_OFFSET);
+
+    // Carregar o Root Directory
+    delete rootDir;
+    rootDir = new RootDirectoryManager(br.rootEntryCount);
+    uint32_t rootDirOffset = (reservedSectors + (br.numberOfFATs * br.sectorsPerFAT)) * 512;
+    rootDir->loadFromDisk(disk, rootDirOffset);
+
+    // Carregar a Área de Dados, do disco ou de todas as imagens em paralelo
+    delete dataArea;
+    uint32_t clusterSize = 512 * br.sectorsPerCluster;
+    dataArea = new DataAreaManager(clusterSize, clusterCount);
+    uint32_t dataAreaOffset = rootDirOffset + (br.rootEntryCount * 32);
+    if (br.stripeCount == 0) {
+        dataArea->loadFromDisk(disk, dataAreaOffset);
+    } else {
+        dataArea->loadFromStripes(stripes, br.stripeClusters);
+    }
+
+    return true;
+}
+
+// Salva a Área de Dados no disco ou, se o volume for distribuído, em todas as imagens em paralelo
+void FileSystem::saveDataArea(uint32_t dataAreaOffset) {
+    BootRecord br = bootRecord.getBootRecord();
+    if (br.stripeCount == 0) {
+        dataArea->saveToDisk(disk, dataAreaOffset);
+    } else {
+        dataArea->saveToStripes(stripes, br.stripeClusters);
+    }
+}
+
+// Salva apenas os clusters alterados por uma operação, no disco ou nas imagens da Área de Dados
+void FileSystem::saveDataClusters(uint32_t dataAreaOffset, const std::vector<uint16_t>& clusters) {
+    BootRecord br = bootRecord.getBootRecord();
+    if (br.stripeCount == 0) {
+        dataArea->saveClustersToDisk(disk, dataAreaOffset, clusters);
+    } else {
+        dataArea->saveClustersToStripes(stripes, br.stripeClusters, clusters);
+    }
+}
+
 //Cópia de um arquivo do disco rígido para o sistema de arquivos 
 bool FileSystem::copyToSystem(const std::string& sourcePath, const std::string& destFileName) {
+    TraceScope scope(trace, TRACE_PUT, destFileName);
+
     // Abrir o arquivo de origem
     std::ifstream inFile(sourcePath, std::ios::binary);
     if (!inFile) {
@@ -69,31 +176,62 @@ bool FileSystem::copyToSystem(const std::string& sourcePath, const std::string&
         return false;
     }
 
-    // Obter o tamanho do arquivo
+    // Ler o conteúdo do arquivo de uma vez quando o tamanho é conhecido
+    uint32_t clusterSize = dataArea->getClusterSize();
+    std::vector<char> fileData;
     inFile.seekg(0, std::ios::end);
-    uint32_t fileSize = inFile.tellg();
-    inFile.seekg(0, std::ios::beg);
-
-    // Ler o conteúdo do arquivo
-    std::vector<char> fileData(fileSize);
-    inFile.read(fileData.data(), fileSize);
+    std::streamoff sourceSize = inFile.tellg();
+    if (sourceSize >= 0) {
+        inFile.seekg(0, std::ios::beg);
+        fileData.resize(sourceSize);
+        inFile.read(fileData.data(), sourceSize);
+        fileData.resize(inFile.gcount());
+    } else {
+        // Origem sem posicionamento (ex.: pipe): ler em blocos até o fim
+        inFile.clear();
+        std::vector<char> chunk(clusterSize);
+        while (inFile.read(chunk.data(), chunk.size()) || inFile.gcount() > 0) {
+            fileData.insert(fileData.end(), chunk.data(), chunk.data() + inFile.gcount());
+        }
+    }
     inFile.close();
+    uint32_t fileSize = fileData.size();
+    scope.size = fileSize;
+
+    // Arquivos muito pequenos ficam inline no Root Directory, sem cluster na FAT nem acesso à Área de Dados
+    if (fileSize <= INLINE_MAX_SIZE && rootDir->addInlineFile(destFileName, fileData.data(), fileSize)) {
+        uint32_t rootDirOffset = (1 + (bootRecord.getBootRecord().numberOfFATs * bootRecord.getBootRecord().sectorsPerFAT)) * 512;
+        rootDir->saveToDisk(disk, rootDirOffset);
+        scope.success = true;
+        return true;
+    }
+
+    // Arquivos menores que um cluster dividem um cluster compartilhado com outros arquivos pequenos
+    if (fileSize <= clusterSize - clusterSize / TAIL_SLOTS_PER_CLUSTER) {
+        scope.success = storePackedFile(destFileName, fileData.data(), fileSize);
+        return scope.success;
+    }
 
     // Calcular o número de clusters necessários
-    uint32_t clusterSize = dataArea->getClusterSize();
     uint32_t clustersNeeded = (fileSize + clusterSize - 1) / clusterSize; //Divide o tamanho do arquivo pelo tamanho do cluster e arredonda para cima
 
-    // Alocar clusters na FAT
+    // Alocar clusters na FAT (com o tamanho final, o alocador consegue escolher uma sequência contígua)
     auto clusters = fat->allocateClusters(clustersNeeded);
     if (clusters.empty()) {
         std::cerr << "Sem espaço para alocar clusters!" << std::endl;
         return false;
     }
 
-    // Escrever os dados na Área de Dados
-    for (size_t i = 0; i < clusters.size(); ++i) {
-        uint32_t sizeToWrite = (i == clusters.size() - 1) ? (fileSize % clusterSize ? fileSize % clusterSize : clusterSize) : clusterSize; //Para o último cluster, escreve apenas o restante do arquivo (fileSize % clusterSize) || Para os outros clusters, escreve o tamanho total do cluster (clusterSize).
-        dataArea->writeData(clusters[i], fileData.data() + i * clusterSize, sizeToWrite);  
+    // Escrever os dados na Área de Dados, uma sequência contígua de clusters por vez
+    for (size_t i = 0; i < clusters.size();) {
+        size_t run = 1;
+        while (i + run < clusters.size() && clusters[i + run] == clusters[i] + run) {
+            ++run;
+        }
+        uint32_t offset = i * clusterSize;
+        uint32_t sizeToWrite = std::min<uint32_t>(run * clusterSize, fileSize - offset); //No último cluster, escreve apenas o restante do arquivo
+        dataArea->writeClusters(clusters[i], run, fileData.data() + offset, sizeToWrite);
+        i += run;
     }
 
     // Adicionar entrada no Root Directory
@@ -105,23 +243,95 @@ bool FileSystem::copyToSystem(const std::string& sourcePath, const std::string&
 
     // Salvar as alterações no disco
     uint32_t fatOffset = 512;
-    fat->saveToDisk(disk, fatOffset);
+    fat->saveWithSummaryToDisk(disk, fatOffset, FREE_SUMMARY_OFFSET);
+    uint32_t rootDirOffset = (1 + (bootRecord.getBootRecord().numberOfFATs * bootRecord.getBootRecord().sectorsPerFAT)) * 512;
+    rootDir->saveToDisk(disk, rootDirOffset);
+    uint32_t dataAreaOffset = rootDirOffset + (bootRecord.getBootRecord().rootEntryCount * 32);
+    saveDataClusters(dataAreaOffset, clusters);
+
+    scope.success = true;
+    return true;
+}
+
+// Guarda um arquivo menor que um cluster em fatias livres de um cluster compartilhado
+bool FileSystem::storePackedFile(const std::string& fileName, const char* data, uint32_t fileSize) {
+    uint32_t slotSize = dataArea->getClusterSize() / TAIL_SLOTS_PER_CLUSTER;
+    uint32_t slotsNeeded = (fileSize + slotSize - 1) / slotSize;
+
+    // Montar o mapa de fatias ocupadas de cada cluster compartilhado a partir do Root Directory
+    std::map<uint16_t, uint8_t> usedSlots;
+    for (const auto& entry : rootDir->getEntries()) {
+        if (entry.fileName[0] == 0 || RootDirectoryManager::isExtension(entry) || !(entry.attributes & ATTR_PACKED)) {
+            continue;
+        }
+        uint32_t entrySlots = (entry.fileSize + slotSize - 1) / slotSize;
+        usedSlots[entry.startCluster] |= ((1u << entrySlots) - 1) << entry.tailSlot;
+    }
+
+    // Procurar fatias livres consecutivas suficientes em um cluster já compartilhado (first fit)
+    uint16_t cluster = CLUSTER_EOF;
+    uint8_t tailSlot = 0;
+    uint32_t mask = (1u << slotsNeeded) - 1;
+    for (const auto& packed : usedSlots) {
+        for (uint32_t slot = 0; slot + slotsNeeded <= TAIL_SLOTS_PER_CLUSTER; ++slot) {
+            if ((packed.second & (mask << slot)) == 0) {
+                cluster = packed.first;
+                tailSlot = slot;
+                break;
+            }
+        }
+        if (cluster != CLUSTER_EOF) {
+            break;
+        }
+    }
+
+    // Sem fatias livres: separar um novo cluster para ser compartilhado
+    bool newCluster = false;
+    if (cluster == CLUSTER_EOF) {
+        auto clusters = fat->allocateClusters(1);
+        if (clusters.empty()) {
+            std::cerr << "Sem espaço para alocar clusters!" << std::endl;
+            return false;
+        }
+        cluster = clusters[0];
+        fat->setNextCluster(cluster, CLUSTER_PACKED);
+        newCluster = true;
+    }
+
+    // Adicionar entrada no Root Directory
+    if (!rootDir->addPackedFile(fileName, fileSize, cluster, tailSlot)) {
+        std::cerr << "Sem espaço no Root Directory!" << std::endl;
+        if (newCluster) {
+            fat->setNextCluster(cluster, CLUSTER_FREE); // Liberar o cluster separado
+        }
+        return false;
+    }
+
+    // Escrever os dados na fatia reservada
+    dataArea->writeDataAt(cluster, tailSlot * slotSize, data, fileSize);
+
+    // Salvar as alterações no disco
+    uint32_t fatOffset = 512;
+    fat->saveWithSummaryToDisk(disk, fatOffset, FREE_SUMMARY_OFFSET);
     uint32_t rootDirOffset = (1 + (bootRecord.getBootRecord().numberOfFATs * bootRecord.getBootRecord().sectorsPerFAT)) * 512;
     rootDir->saveToDisk(disk, rootDirOffset);
     uint32_t dataAreaOffset = rootDirOffset + (bootRecord.getBootRecord().rootEntryCount * 32);
-    dataArea->saveToDisk(disk, dataAreaOffset);
+    saveDataClusters(dataAreaOffset, std::vector<uint16_t>(1, cluster));
 
     return true;
 }
 
 //Cópia de um arquivo do sistema de arquivos para o disco rígido 
 bool FileSystem::copyFromSystem(const std::string& fileName, const std::string& destPath) {
+    TraceScope scope(trace, TRACE_GET, fileName);
+
     // Encontrar o arquivo no Root Directory
     RootEntry* entry = rootDir->findFile(fileName);
     if (!entry) {
         std::cerr << "Arquivo não encontrado: " << fileName << std::endl;
         return false;
     }
+    scope.size = entry->fileSize;
 
     // Abrir o arquivo de destino
     std::ofstream outFile(destPath, std::ios::binary);
@@ -132,30 +342,93 @@ bool FileSystem::copyFromSystem(const std::string& fileName, const std::string&
 
     // Ler os dados da Área de Dados
     std::vector<char> buffer(entry->fileSize);
+    uint32_t clusterSize = dataArea->getClusterSize();
+
+    // Arquivos pequenos são lidos de uma vez, sem percorrer a FAT
+    if (entry->attributes & (ATTR_INLINE | ATTR_PACKED)) {
+        if (entry->attributes & ATTR_INLINE) {
+            rootDir->readInlineData(entry, buffer.data()); // Dados no próprio Root Directory
+        } else {
+            uint32_t slotOffset = entry->tailSlot * (clusterSize / TAIL_SLOTS_PER_CLUSTER);
+            dataArea->readDataAt(entry->startCluster, slotOffset, buffer.data(), entry->fileSize);
+        }
+        outFile.write(buffer.data(), entry->fileSize);
+        outFile.close();
+        scope.success = true;
+        return true;
+    }
+
     uint16_t cluster = entry->startCluster;
     size_t bytesRead = 0;
-    while (cluster != CLUSTER_EOF) {
-        uint32_t sizeToRead = std::min<uint32_t>(dataArea->getClusterSize(), entry->fileSize - bytesRead);
-        dataArea->readData(cluster, buffer.data() + bytesRead, sizeToRead);
+    while (cluster != CLUSTER_EOF && bytesRead < entry->fileSize) {
+        // Agrupar os próximos clusters da cadeia enquanto forem contíguos
+        // (CLUSTER_EOF e outros marcadores nunca contam como o próximo cluster, mesmo que valham firstCluster + run)
+        uint16_t firstCluster = cluster;
+        uint32_t run = 1;
+        uint16_t nextCluster = fat->getNextCluster(cluster);
+        while (nextCluster != CLUSTER_EOF && nextCluster < dataArea->getClusterCount() &&
+               nextCluster == firstCluster + run) {
+            nextCluster = fat->getNextCluster(nextCluster);
+            ++run;
+        }
+
+        // Ler a sequência inteira de uma vez
+        uint32_t sizeToRead = std::min<uint32_t>(run * clusterSize, entry->fileSize - bytesRead);
+        dataArea->readClusters(firstCluster, run, buffer.data() + bytesRead, sizeToRead);
         bytesRead += sizeToRead;
-        cluster = fat->getNextCluster(cluster);
+        cluster = nextCluster;
     }
 
     // Escrever os dados no arquivo de destino
     outFile.write(buffer.data(), entry->fileSize);
     outFile.close();
 
+    scope.success = true;
     return true;
 }
 
 //Listagem dos arquivos armazenados no sistema de arquivos 
 void FileSystem::listFiles() const {
+    TraceScope scope(trace, TRACE_LS, "");
     rootDir->listFiles();
+    scope.success = true;
+}
+
+//Estatísticas de espaço livre, lidas do resumo mantido pela FAT (sem varrer a tabela)
+void FileSystem::showFreeSpace() const {
+    const FreeSpaceSummary& summary = fat->getFreeSpaceSummary();
+    uint32_t clusterSize = dataArea->getClusterSize();
+    std::cout << "Clusters livres: " << summary.freeClusters << " de " << fat->getClusterCount()
+              << " (" << summary.freeClusters * clusterSize << " bytes)" << std::endl;
+
+    // Histograma das sequências livres
+    for (uint32_t bucket = 0; bucket < FREE_RUN_BUCKETS; ++bucket) {
+        if (summary.freeRunHistogram[bucket] > 0) {
+            std::cout << "Sequências livres de " << (1u << bucket) << " a " << (2u << bucket) - 1
+                      << " clusters: " << summary.freeRunHistogram[bucket] << std::endl;
+        }
+    }
+
+    // Clusters livres por região
+    std::cout << "Clusters livres por região (" << summary.regionSize << " clusters cada):";
+    for (uint32_t region = 0; region * summary.regionSize < fat->getClusterCount(); ++region) {
+        std::cout << " " << summary.regionFree[region];
+    }
+    std::cout << std::endl;
+
+    // Maior sequência livre que começa em cada região
+    std::cout << "Maior sequência livre por região:";
+    for (uint32_t region = 0; region * summary.regionSize < fat->getClusterCount(); ++region) {
+        std::cout << " " << summary.regionMaxRun[region];
+    }
+    std::cout << std::endl;
 }
 
 
 //Remoção de arquivos 
 bool FileSystem::removeFile(const std::string& fileName) {
+    TraceScope scope(trace, TRACE_RM, fileName);
+
     // Encontrar o arquivo no Root Directory
     RootEntry* entry = rootDir->findFile(fileName);
     if (!entry) {
@@ -163,17 +436,76 @@ bool FileSystem::removeFile(const std::string& fileName) {
         return false;
     }
 
-    // Liberar os clusters na FAT
-    fat->freeClusters(entry->startCluster);
-
-    // Remover a entrada do Root Directory
+    // Remover a entrada do Root Directory (guardando uma cópia para liberar os clusters)
+    RootEntry removed = *entry;
     rootDir->removeFile(fileName);
 
+    // Liberar os clusters na FAT
+    if (removed.attributes & ATTR_PACKED) {
+        // Um cluster compartilhado só é liberado quando o último arquivo guardado nele sai
+        bool inUse = false;
+        for (const auto& other : rootDir->getEntries()) {
+            if (other.fileName[0] != 0 && !RootDirectoryManager::isExtension(other) &&
+                (other.attributes & ATTR_PACKED) && other.startCluster == removed.startCluster) {
+                inUse = true;
+                break;
+            }
+        }
+        if (!inUse) {
+            fat->setNextCluster(removed.startCluster, CLUSTER_FREE);
+        }
+    } else if (!(removed.attributes & ATTR_INLINE)) {
+        fat->freeClusters(removed.startCluster);
+    }
+
     // Salvar as alterações no disco
     uint32_t fatOffset = 512;
-    fat->saveToDisk(disk, fatOffset);
+    fat->saveWithSummaryToDisk(disk, fatOffset, FREE_SUMMARY_OFFSET);
     uint32_t rootDirOffset = (1 + (bootRecord.getBootRecord().numberOfFATs * bootRecord.getBootRecord().sectorsPerFAT)) * 512;
     rootDir->saveToDisk(disk, rootDirOffset);
 
+    scope.success = true;
     return true;
+}
+
+//Estatísticas de fragmentação: sequências contíguas de cada arquivo em cadeia e sequências livres
+FragmentationStats FileSystem::getFragmentation() const {
+    FragmentationStats stats = {0, 0, 0, 0};
+    for (const auto& entry : rootDir->getEntries()) {
+        if (entry.fileName[0] == 0 || RootDirectoryManager::isExtension(entry) ||
+            (entry.attributes & (ATTR_INLINE | ATTR_PACKED))) {
+            continue; // Entradas vazias e arquivos pequenos não ocupam cadeias
+        }
+
+        // Contar as quebras de continuidade ao longo da cadeia
+        uint32_t extents = 1;
+        uint32_t steps = 0;
+        uint16_t cluster = entry.startCluster;
+        uint16_t nextCluster = fat->getNextCluster(cluster);
+        while (nextCluster != CLUSTER_EOF && nextCluster < fat->getClusterCount() && ++steps < fat->getClusterCount()) {
+            if (nextCluster != cluster + 1) {
+                ++extents;
+            }
+            cluster = nextCluster;
+            nextCluster = fat->getNextCluster(cluster);
+        }
+
+        ++stats.chainedFiles;
+        stats.extents += extents;
+        if (extents > 1) {
+            ++stats.fragmentedFiles;
+        }
+    }
+
+    // As sequências livres vêm do histograma mantido pela FAT
+    const FreeSpaceSummary& summary = fat->getFreeSpaceSummary();
+    for (uint32_t bucket = 0; bucket < FREE_RUN_BUCKETS; ++bucket) {
+        stats.freeRuns += summary.freeRunHistogram[bucket];
+    }
+    return stats;
+}
+
+// Define o gravador que registra as operações (nullptr desativa a gravação)
+void FileSystem::setTraceRecorder(TraceRecorder* recorder) {
+    trace = recorder;
 }
\ No newline at end of file
@@ -5,19 +5,35 @@
 #include "FAT.h"
 #include "RootDirectory.h"
 #include "DataArea.h"
+#include "TraceRecorder.h"
 #include <string>
+#include <vector>
+
+// Estatísticas de fragmentação do volume
+struct FragmentationStats {
+    uint32_t chainedFiles;     // Arquivos guardados em cadeia de clusters
+    uint32_t fragmentedFiles;  // Arquivos com mais de uma sequência contígua de clusters
+    uint32_t extents;          // Total de sequências contíguas de clusters dos arquivos
+    uint32_t freeRuns;         // Sequências de clusters livres
+};
 
 class FileSystem {
 public:
     // Construtor: inicializa o sistema de arquivos com o caminho do disco
     FileSystem(const std::string& diskPath);
 
-    // Destrutor: fecha o disco
+    // Construtor: a Área de Dados é distribuída entre as imagens em stripePaths
+    FileSystem(const std::string& diskPath, const std::vector<std::string>& stripePaths);
+
+    // Destrutor: fecha o disco e as imagens da Área de Dados
     ~FileSystem();
 
     // Formata o sistema de arquivos
     bool format(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster);
 
+    // Monta um sistema de arquivos já formatado, carregando as estruturas do disco
+    bool mount();
+
     // Copia um arquivo do disco rígido para o sistema de arquivos
     bool copyToSystem(const std::string& sourcePath, const std::string& destFileName);
 
@@ -27,15 +43,38 @@ public:
     // Lista os arquivos armazenados no sistema de arquivos
     void listFiles() const;
 
+    // Mostra as estatísticas de espaço livre
+    void showFreeSpace() const;
+
     // Remove um arquivo do sistema de arquivos
     bool removeFile(const std::string& fileName);
 
+    // Obtém as estatísticas de fragmentação do volume
+    FragmentationStats getFragmentation() const;
+
+    // Define o gravador que registra as operações (nullptr desativa a gravação)
+    void setTraceRecorder(TraceRecorder* recorder);
+
 private:
     FILE* disk;                    // Arquivo que simula o disco
+    std::vector<FILE*> stripes;    // Imagens que recebem a Área de Dados distribuída (vazio = no próprio disco)
     BootRecordManager bootRecord;  // Gerenciador do Boot Record
     FATManager* fat;               // Gerenciador da FAT
     RootDirectoryManager* rootDir; // Gerenciador do Root Directory
     DataAreaManager* dataArea;     // Gerenciador da Área de Dados
+    TraceRecorder* trace;          // Gravador de operações (nullptr = sem gravação)
+
+    // Salva a Área de Dados no disco ou, se o volume for distribuído, em todas as imagens em paralelo
+    void saveDataArea(uint32_t dataAreaOffset);
+
+    // Salva apenas os clusters alterados por uma operação, no disco ou nas imagens da Área de Dados
+    void saveDataClusters(uint32_t dataAreaOffset, const std::vector<uint16_t>& clusters);
+
+    // Número de fatias em que um cluster compartilhado é dividido para guardar arquivos pequenos
+    static const uint32_t TAIL_SLOTS_PER_CLUSTER = 8;
+
+    // Guarda um arquivo menor que um cluster em fatias livres de um cluster compartilhado
+    bool storePackedFile(const std::string& fileName, const char* data, uint32_t fileSize);
 };
 
 #endif // FILE_SYSTEM_H
\ No newline at end of file
@@ -1,9 +1,11 @@
-//g++ -o filesystem Main.cpp BootRecord.cpp FAT.cpp RootDirectory.cpp DataArea.cpp FileSystem.cpp
+//g++ -pthread -o filesystem Main.cpp BootRecord.cpp FAT.cpp RootDirectory.cpp DataArea.cpp FileSystem.cpp TraceRecorder.cpp
 
 #include "FileSystem.h"
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <vector>
+#include <memory>
 
 using namespace std;
 
@@ -11,7 +13,7 @@ int main() {
     try {
         // Definir parâmetros do sistema de arquivos
         uint32_t TOTAL_SECTORS;
-        const uint16_t ROOT_ENTRY_COUNT = 16; // Número de entradas no Root Directory
+        const uint16_t ROOT_ENTRY_COUNT = 64; // Número de entradas no Root Directory
         const uint8_t SECTORS_PER_CLUSTER = 1; // Setores por cluster
         const uint32_t BYTES_PER_SECTOR = 512; // Bytes por setor (definido no BootRecord)
         string DISK_PATH; // Nome do arquivo .img, será definido pelo usuário
@@ -26,40 +28,93 @@ int main() {
             DISK_PATH = "filesystem.img";
         }
 
-        // Pedir ao usuário o tamanho em setores
-        cout << "Digite o tamanho da partição em setores (ex.: 1000): ";
-        cin >> TOTAL_SECTORS;
+        // Pedir ao usuário se a imagem será formatada ou montada
+        int MODE;
+        cout << "Digite 1 para formatar uma nova imagem ou 2 para montar uma imagem existente: ";
+        cin >> MODE;
         cin.ignore(); // Limpar o buffer do \n
 
         // Validar entrada
-        if (TOTAL_SECTORS < 10) { // Valor mínimo para garantir espaço para as estruturas
-            cerr << "Tamanho muito pequeno! Deve ser pelo menos 10 setores." << endl;
+        if (MODE != 1 && MODE != 2) {
+            cerr << "Opção inválida!" << endl;
             return 1;
         }
 
-        // Criar o arquivo .img com o tamanho apropriado usando FILE*
-        cout << "Criando arquivo " << DISK_PATH << "..." << endl;
-        FILE* imgFile = fopen(DISK_PATH.c_str(), "wb");
-        if (!imgFile) {
-            cerr << "Erro ao criar o arquivo " << DISK_PATH << "!" << endl;
+        if (MODE == 1) {
+            // Pedir ao usuário o tamanho em setores
+            cout << "Digite o tamanho da partição em setores (ex.: 1000): ";
+            cin >> TOTAL_SECTORS;
+            cin.ignore(); // Limpar o buffer do \n
+
+            // Validar entrada
+            if (TOTAL_SECTORS < 10) { // Valor mínimo para garantir espaço para as estruturas
+                cerr << "Tamanho muito pequeno! Deve ser pelo menos 10 setores." << endl;
+                return 1;
+            }
+
+            // Criar o arquivo .img com o tamanho apropriado usando FILE*
+            cout << "Criando arquivo " << DISK_PATH << "..." << endl;
+            FILE* imgFile = fopen(DISK_PATH.c_str(), "wb");
+            if (!imgFile) {
+                cerr << "Erro ao criar o arquivo " << DISK_PATH << "!" << endl;
+                return 1;
+            }
+
+            // Preencher o arquivo com zeros para reservar o espaço
+            fseek(imgFile, TOTAL_SECTORS * BYTES_PER_SECTOR - 1, SEEK_SET);
+            fputc(0, imgFile); // Escrever um byte no final para definir o tamanho
+            fclose(imgFile);
+        }
+
+        // Pedir ao usuário o número de imagens para distribuir a Área de Dados
+        uint32_t STRIPE_COUNT;
+        cout << "Digite o número de imagens para distribuir a Área de Dados (0 = usar apenas o .img): ";
+        cin >> STRIPE_COUNT;
+        cin.ignore(); // Limpar o buffer do \n
+
+        // Validar entrada
+        if (STRIPE_COUNT > 255) {
+            cerr << "Número de imagens muito grande! Deve ser no máximo 255." << endl;
             return 1;
         }
 
-        // Preencher o arquivo com zeros para reservar o espaço
-        fseek(imgFile, TOTAL_SECTORS * BYTES_PER_SECTOR - 1, SEEK_SET);
-        fputc(0, imgFile); // Escrever um byte no final para definir o tamanho
-        fclose(imgFile);
+        // As imagens da Área de Dados recebem o nome do .img seguido do índice (ex.: filesystem.img.0)
+        vector<string> stripePaths;
+        for (uint32_t i = 0; i < STRIPE_COUNT; ++i) {
+            stripePaths.push_back(DISK_PATH + "." + to_string(i));
+        }
 
-        // Criar o sistema de arquivos
-        FileSystem fs(DISK_PATH);
+        // Pedir ao usuário o arquivo de trace (opcional): registra as operações para o replay
+        string TRACE_PATH;
+        cout << "Digite o nome do arquivo de trace para gravar as operações (vazio = não gravar): ";
+        getline(cin, TRACE_PATH);
+        unique_ptr<TraceRecorder> recorder;
+        if (!TRACE_PATH.empty()) {
+            recorder.reset(new TraceRecorder(TRACE_PATH));
+        }
 
-        // Formatar o sistema
-        cout << "Formatando o sistema de arquivos..." << endl;
-        if (fs.format(TOTAL_SECTORS, ROOT_ENTRY_COUNT, SECTORS_PER_CLUSTER)) {
-            cout << "Formatação concluída com sucesso!" << endl;
+        // Criar o sistema de arquivos
+        FileSystem fs(DISK_PATH, stripePaths);
+        fs.setTraceRecorder(recorder.get());
+
+        if (MODE == 1) {
+            // Formatar o sistema
+            cout << "Formatando o sistema de arquivos..." << endl;
+            if (fs.format(TOTAL_SECTORS, ROOT_ENTRY_COUNT, SECTORS_PER_CLUSTER)) {
+                cout << "Formatação concluída com sucesso!" << endl;
+            } else {
+                cout << "Falha na formatação." << endl;
+                return 1;
+            }
         } else {
-            cout << "Falha na formatação." << endl;
-            return 1;
+            // Montar o sistema existente
+            cout << "Montando o sistema de arquivos..." << endl;
+            if (fs.mount()) {
+                cout << "Montagem concluída com sucesso!" << endl;
+            } else {
+                cout << "Falha na montagem." << endl;
+                return 1;
+            }
         }
 
         // Menu interativo
@@ -72,12 +127,13 @@ int main() {
             cout << "2. Copiar arquivo do sistema para o disco" << endl;
             cout << "3. Listar arquivos" << endl;
             cout << "4. Remover arquivo" << endl;
-            cout << "5. Sair" << endl;
-            cout << "Escolha uma opção (1-5): ";
+            cout << "5. Mostrar espaço livre" << endl;
+            cout << "6. Sair" << endl;
+            cout << "Escolha uma opção (1-6): ";
             cin >> choice;
             cin.ignore(); // Limpar o buffer do \n
 
-            if (choice == 5) {
+            if (choice == 6) {
                 cout << "Saindo..." << endl;
                 break;
             }
@@ -122,6 +178,11 @@ int main() {
                     }
                     break;
 
+                case 5: // Mostrar espaço livre
+                    cout << "\nEspaço livre no sistema:" << endl;
+                    fs.showFreeSpace();
+                    break;
+
                 default:
                     cout << "Opção inválida! Tente novamente." << endl;
             }
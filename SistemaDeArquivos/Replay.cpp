@@ -0,0 +1,53 @@
+//g++ -pthread -o replay Replay.cpp TraceReplayer.cpp TraceRecorder.cpp BootRecord.cpp FAT.cpp RootDirectory.cpp DataArea.cpp FileSystem.cpp
+
+#include "TraceReplayer.h"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+int main() {
+    try {
+        string TRACE_PATH; // Arquivo de trace gravado pelo filesystem
+        string DISK_PATH;  // Imagem nova usada na execução
+        int TIMING;        // 1 = instantes gravados, 2 = velocidade máxima
+        uint32_t THREADS;  // Número de threads
+
+        // Pedir ao usuário o arquivo de trace
+        cout << "Digite o nome do arquivo de trace (ex.: filesystem.trace): ";
+        getline(cin, TRACE_PATH);
+
+        // Pedir ao usuário o nome da imagem nova
+        cout << "Digite o nome do arquivo .img para a execução (ex.: replay.img): ";
+        getline(cin, DISK_PATH);
+        if (DISK_PATH.empty()) {
+            cerr << "Nome do arquivo não pode ser vazio! Usando 'replay.img' como padrão." << endl;
+            DISK_PATH = "replay.img";
+        }
+
+        // Pedir ao usuário o modo de execução
+        cout << "Temporização: 1. Instantes originais  2. Velocidade máxima (1-2): ";
+        cin >> TIMING;
+        cout << "Digite o número de threads (ex.: 1): ";
+        cin >> THREADS;
+
+        // Validar entrada
+        if (!cin || (TIMING != 1 && TIMING != 2) || THREADS < 1) {
+            cerr << "Opção inválida!" << endl;
+            return 1;
+        }
+
+        // Executar o trace
+        TraceReplayer replayer(TRACE_PATH);
+        cout << "Executando o trace em " << DISK_PATH << "..." << endl;
+        if (!replayer.replay(DISK_PATH, TIMING == 1, THREADS)) {
+            cout << "Falha na execução do trace." << endl;
+            return 1;
+        }
+    } catch (const exception& e) {
+        cerr << "Erro: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
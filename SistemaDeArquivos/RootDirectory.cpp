@@ -1,5 +1,6 @@
 #include "RootDirectory.h"
 #include <cstring>
+#include <algorithm>
 #include <iostream>
 #include <ctime>
 
@@ -16,31 +17,112 @@ void RootDirectoryManager::initialize() {
     }
 }
 
+// Reserva count entradas vazias consecutivas e preenche a primeira; retorna nullptr se não houver
+RootEntry* RootDirectoryManager::reserveEntries(const std::string& fileName, uint32_t fileSize, uint32_t count) {
+    // Procurar count entradas vazias seguidas
+    uint32_t freeRun = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        freeRun = (entries[i].fileName[0] == 0) ? freeRun + 1 : 0; // Entrada vazia
+        if (freeRun < count) {
+            continue;
+        }
+
+        // Preencher os campos
+        RootEntry& entry = entries[i + 1 - count];
+        strncpy(entry.fileName, fileName.c_str(), 16);
+        entry.fileName[15] = '\0'; // Garantir terminação nula
+        entry.fileSize = fileSize;
+        entry.startCluster = 0;
+        entry.attributes = ATTR_ARCHIVE; // Atributo de arquivo comum
+        entry.tailSlot = 0;
+        entry.creationTime = static_cast<uint32_t>(time(nullptr));
+        entry.modificationTime = entry.creationTime;
+        return &entry;
+    }
+    return nullptr; // Sem espaço no Root Directory
+}
+
+// Verifica se uma entrada é de extensão (guarda dados inline de outra entrada)
+bool RootDirectoryManager::isExtension(const RootEntry& entry) {
+    return entry.fileName[0] == INLINE_EXTENSION_MARKER;
+}
+
 // Adiciona um arquivo ao Root Directory
 bool RootDirectoryManager::addFile(const std::string& fileName, uint32_t fileSize, uint16_t startCluster) {
-    // Procurar uma entrada vazia
-    for (auto& entry : entries) {
-        if (entry.fileName[0] == 0) { // Entrada vazia
-            // Preencher os campos
-            strncpy(entry.fileName, fileName.c_str(), 16);
-            entry.fileName[15] = '\0'; // Garantir terminação nula
-            entry.fileSize = fileSize;
-            entry.startCluster = startCluster;
-            entry.attributes = 0x20; // Atributo de arquivo comum
-            entry.creationTime = static_cast<uint32_t>(time(nullptr));
-            entry.modificationTime = entry.creationTime;
-            return true;
+    RootEntry* entry = reserveEntries(fileName, fileSize, 1);
+    if (!entry) {
+        return false; // Sem espaço no Root Directory
+    }
+    entry->startCluster = startCluster;
+    return true;
+}
+
+// Adiciona um arquivo pequeno com os dados guardados no próprio Root Directory
+bool RootDirectoryManager::addInlineFile(const std::string& fileName, const char* data, uint32_t fileSize) {
+    if (fileSize > INLINE_MAX_SIZE) {
+        return false; // Grande demais para ficar inline
+    }
+    uint32_t extensionCount = (fileSize + INLINE_BYTES_PER_ENTRY - 1) / INLINE_BYTES_PER_ENTRY;
+
+    // Não gastar entradas de extensão se isso deixar o Root Directory sem a reserva de entradas livres
+    uint32_t freeEntries = 0;
+    for (const auto& e : entries) {
+        if (e.fileName[0] == 0) {
+            ++freeEntries;
         }
     }
-    return false; // Sem espaço no Root Directory
+    uint32_t reserve = entries.size() / INLINE_RESERVE_DIVISOR;
+    if (extensionCount > 0 && freeEntries < 1 + extensionCount + reserve) {
+        return false; // O arquivo usa o caminho comum
+    }
+
+    RootEntry* entry = reserveEntries(fileName, fileSize, 1 + extensionCount);
+    if (!entry) {
+        return false; // Sem espaço no Root Directory
+    }
+    entry->attributes = ATTR_ARCHIVE | ATTR_INLINE;
+
+    // Copiar os dados para as entradas de extensão seguintes
+    for (uint32_t i = 0; i < extensionCount; ++i) {
+        char* raw = reinterpret_cast<char*>(entry + 1 + i);
+        uint32_t chunk = std::min(INLINE_BYTES_PER_ENTRY, fileSize - i * INLINE_BYTES_PER_ENTRY);
+        memset(raw, 0, sizeof(RootEntry));
+        raw[0] = INLINE_EXTENSION_MARKER;
+        memcpy(raw + 1, data + i * INLINE_BYTES_PER_ENTRY, chunk);
+    }
+    return true;
+}
+
+// Adiciona um arquivo guardado a partir da fatia tailSlot de um cluster compartilhado
+bool RootDirectoryManager::addPackedFile(const std::string& fileName, uint32_t fileSize, uint16_t cluster, uint8_t tailSlot) {
+    RootEntry* entry = reserveEntries(fileName, fileSize, 1);
+    if (!entry) {
+        return false; // Sem espaço no Root Directory
+    }
+    entry->startCluster = cluster;
+    entry->attributes = ATTR_ARCHIVE | ATTR_PACKED;
+    entry->tailSlot = tailSlot;
+    return true;
+}
+
+// Lê os dados de um arquivo guardado inline
+void RootDirectoryManager::readInlineData(const RootEntry* entry, char* buffer) const {
+    for (uint32_t i = 0; i * INLINE_BYTES_PER_ENTRY < entry->fileSize; ++i) {
+        const char* raw = reinterpret_cast<const char*>(entry + 1 + i);
+        uint32_t chunk = std::min(INLINE_BYTES_PER_ENTRY, entry->fileSize - i * INLINE_BYTES_PER_ENTRY);
+        memcpy(buffer + i * INLINE_BYTES_PER_ENTRY, raw + 1, chunk);
+    }
 }
 
 // Remove um arquivo do Root Directory
 bool RootDirectoryManager::removeFile(const std::string& fileName) {
-    for (auto& entry : entries) {
-        if (strncmp(entry.fileName, fileName.c_str(), 16) == 0) {
-            // Marcar a entrada como vazia
-            memset(&entry, 0, sizeof(RootEntry));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (strncmp(entries[i].fileName, fileName.c_str(), 16) == 0) {
+            // Marcar a entrada e suas entradas de extensão como vazias
+            memset(&entries[i], 0, sizeof(RootEntry));
+            for (size_t j = i + 1; j < entries.size() && isExtension(entries[j]); ++j) {
+                memset(&entries[j], 0, sizeof(RootEntry));
+            }
             return true;
         }
     }
@@ -51,12 +133,19 @@ bool RootDirectoryManager::removeFile(const std::string& fileName) {
 void RootDirectoryManager::listFiles() const {
     bool hasFiles = false; //será usada para determinar se o Root Directory está vazio
     for (const auto& entry : entries) { //número total de entradas no Root Directory
-        if (entry.fileName[0] != 0) { // Entrada não vazia
+        if (entry.fileName[0] != 0 && !isExtension(entry)) { // Entrada não vazia
             hasFiles = true;
             std::cout << "File: " << entry.fileName
-                      << ", Size: " << entry.fileSize << " bytes"
-                      << ", Start Cluster: " << entry.startCluster
-                      << std::endl;
+                      << ", Size: " << entry.fileSize << " bytes";
+            if (entry.attributes & ATTR_INLINE) {
+                std::cout << ", Inline";
+            } else {
+                std::cout << ", Start Cluster: " << entry.startCluster;
+                if (entry.attributes & ATTR_PACKED) {
+                    std::cout << ", Tail Slot: " << static_cast<int>(entry.tailSlot);
+                }
+            }
+            std::cout << std::endl;
         }
     }
     if (!hasFiles) {
@@ -74,6 +163,11 @@ RootEntry* RootDirectoryManager::findFile(const std::string& fileName) {
     return nullptr; // Arquivo não encontrado
 }
 
+// Obtém todas as entradas (inclusive vazias e de extensão)
+const std::vector<RootEntry>& RootDirectoryManager::getEntries() const {
+    return entries;
+}
+
 // Salva o Root Directory no disco a partir de um offset
 void RootDirectoryManager::saveToDisk(FILE* disk, uint32_t offset) {
     fseek(disk, offset, SEEK_SET);
@@ -6,12 +6,25 @@
 #include <string>
 #include <cstdio>
 
+// Atributos de uma entrada
+const uint8_t ATTR_ARCHIVE = 0x20;  // Arquivo comum
+const uint8_t ATTR_INLINE = 0x40;   // Dados guardados nas entradas de extensão logo após a entrada
+const uint8_t ATTR_PACKED = 0x80;   // Dados guardados em fatias de um cluster compartilhado (CLUSTER_PACKED)
+
+// Entradas de extensão: o primeiro byte é o marcador e os 31 restantes guardam dados do arquivo
+const char INLINE_EXTENSION_MARKER = 0x01;
+const uint32_t INLINE_BYTES_PER_ENTRY = 31;
+const uint32_t INLINE_MAX_ENTRIES = 2;
+const uint32_t INLINE_MAX_SIZE = INLINE_BYTES_PER_ENTRY * INLINE_MAX_ENTRIES; // Maior arquivo guardado inline
+const uint32_t INLINE_RESERVE_DIVISOR = 4; // 1/4 das entradas fica livre para arquivos que ocupam uma só entrada
+
 // Estrutura de uma entrada no Root Directory (32 bytes)
 struct RootEntry {
     char fileName[16];          // Nome do arquivo (16 bytes)
     uint32_t fileSize;          // Tamanho do arquivo em bytes (4 bytes)
     uint16_t startCluster;      // Primeiro cluster do arquivo (2 bytes)
     uint8_t attributes;         // Atributos do arquivo (1 byte)
+    uint8_t tailSlot;           // Primeira fatia ocupada no cluster compartilhado, se ATTR_PACKED (1 byte)
     uint32_t creationTime;      // Data e hora de criação (4 bytes)
     uint32_t modificationTime;  // Data e hora de modificação (4 bytes)
 };
@@ -27,6 +40,15 @@ public:
     // Adiciona um arquivo ao Root Directory
     bool addFile(const std::string& fileName, uint32_t fileSize, uint16_t startCluster);
 
+    // Adiciona um arquivo pequeno com os dados guardados no próprio Root Directory
+    bool addInlineFile(const std::string& fileName, const char* data, uint32_t fileSize);
+
+    // Adiciona um arquivo guardado a partir da fatia tailSlot de um cluster compartilhado
+    bool addPackedFile(const std::string& fileName, uint32_t fileSize, uint16_t cluster, uint8_t tailSlot);
+
+    // Lê os dados de um arquivo guardado inline
+    void readInlineData(const RootEntry* entry, char* buffer) const;
+
     // Remove um arquivo do Root Directory
     bool removeFile(const std::string& fileName);
 
@@ -36,6 +58,12 @@ public:
     // Encontra um arquivo pelo nome
     RootEntry* findFile(const std::string& fileName);
 
+    // Obtém todas as entradas (inclusive vazias e de extensão)
+    const std::vector<RootEntry>& getEntries() const;
+
+    // Verifica se uma entrada é de extensão (guarda dados inline de outra entrada)
+    static bool isExtension(const RootEntry& entry);
+
     // Salva o Root Directory no disco a partir de um offset
     void saveToDisk(FILE* disk, uint32_t offset);
 
@@ -44,6 +72,9 @@ public:
 
 private:
     std::vector<RootEntry> entries;  // Vetor de entradas do Root Directory
+
+    // Reserva count entradas vazias consecutivas e preenche a primeira; retorna nullptr se não houver
+    RootEntry* reserveEntries(const std::string& fileName, uint32_t fileSize, uint32_t count);
 };
 
 #endif // ROOT_DIRECTORY_H
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "TraceRecorder.h"
+#include <cstring>
+#include <stdexcept>
+
+// Construtor: cria o arquivo de trace
+TraceRecorder::TraceRecorder(const std::string& tracePath) {
+    file = fopen(tracePath.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Erro ao criar o arquivo de trace!");
+    }
+    memset(&header, 0, sizeof(TraceHeader));
+    memcpy(header.magic, "FTRC", 4);
+    fwrite(&header, sizeof(TraceHeader), 1, file);
+    start = std::chrono::steady_clock::now();
+}
+
+// Destrutor: fecha o arquivo de trace
+TraceRecorder::~TraceRecorder() {
+    if (file) {
+        fclose(file);
+    }
+}
+
+// Registra a geometria do volume formatado no cabeçalho
+void TraceRecorder::recordFormat(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster, uint8_t stripeCount) {
+    header.totalSectors = totalSectors;
+    header.rootEntryCount = rootEntryCount;
+    header.sectorsPerCluster = sectorsPerCluster;
+    header.stripeCount = stripeCount;
+
+    // Reescrever o cabeçalho no início do arquivo e voltar para o fim
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(TraceHeader), 1, file);
+    fseek(file, 0, SEEK_END);
+}
+
+// Registra uma operação iniciada no instante timestamp
+void TraceRecorder::record(uint8_t op, const std::string& fileName, uint32_t size, bool success, uint64_t timestamp) {
+    TraceRecord record;
+    memset(&record, 0, sizeof(TraceRecord));
+    record.timestamp = timestamp;
+    record.size = size;
+    record.op = op;
+    record.success = success ? 1 : 0;
+    strncpy(record.fileName, fileName.c_str(), 16);
+    record.fileName[15] = '\0'; // Garantir terminação nula
+    fwrite(&record, sizeof(TraceRecord), 1, file);
+}
+
+// Obtém o instante atual em microssegundos desde o início da gravação
+uint64_t TraceRecorder::now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Carrega um arquivo de trace completo
+bool TraceRecorder::load(const std::string& tracePath, TraceHeader& header, std::vector<TraceRecord>& records) {
+    FILE* traceFile = fopen(tracePath.c_str(), "rb");
+    if (!traceFile) {
+        return false;
+    }
+    if (fread(&header, sizeof(TraceHeader), 1, traceFile) != 1 || memcmp(header.magic, "FTRC", 4) != 0) {
+        fclose(traceFile);
+        return false; // Não é um arquivo de trace
+    }
+    records.clear();
+    TraceRecord record;
+    while (fread(&record, sizeof(TraceRecord), 1, traceFile) == 1) {
+        records.push_back(record);
+    }
+    fclose(traceFile);
+    return true;
+}
+
+// Construtor: marca o instante de início da operação
+TraceScope::TraceScope(TraceRecorder* recorder, uint8_t op, const std::string& fileName) {
+    this->recorder = recorder;
+    this->op = op;
+    this->fileName = fileName;
+    size = 0;
+    success = false;
+    timestamp = recorder ? recorder->now() : 0;
+}
+
+// Destrutor: grava o registro da operação
+TraceScope::~TraceScope() {
+    if (recorder) {
+        recorder->record(op, fileName, size, success, timestamp);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Operações registradas no trace
+const uint8_t TRACE_PUT = 1;  // Cópia de um arquivo para o sistema
+const uint8_t TRACE_GET = 2;  // Cópia de um arquivo do sistema para o disco
+const uint8_t TRACE_RM = 3;   // Remoção de um arquivo
+const uint8_t TRACE_LS = 4;   // Listagem dos arquivos
+
+// Cabeçalho do arquivo de trace (12 bytes): geometria do volume formatado durante a gravação
+struct TraceHeader {
+    char magic[4];              // Assinatura "FTRC" (4 bytes)
+    uint32_t totalSectors;      // Tamanho da partição em setores (4 bytes)
+    uint16_t rootEntryCount;    // Número de entradas no diretório raiz (2 bytes)
+    uint8_t sectorsPerCluster;  // Setores por cluster (1 byte)
+    uint8_t stripeCount;        // Número de imagens da Área de Dados (1 byte)
+};
+
+// Registro de uma operação no trace (32 bytes)
+struct TraceRecord {
+    uint64_t timestamp;         // Instante de início em microssegundos desde o início da gravação (8 bytes)
+    uint32_t size;              // Bytes copiados pela operação (4 bytes)
+    uint8_t op;                 // Operação (TRACE_PUT, TRACE_GET, TRACE_RM ou TRACE_LS) (1 byte)
+    uint8_t success;            // 1 se a operação foi concluída com sucesso (1 byte)
+    uint16_t reserved;          // Reservado (2 bytes)
+    char fileName[16];          // Nome do arquivo no sistema (16 bytes)
+};
+
+class TraceRecorder {
+public:
+    // Construtor: cria o arquivo de trace
+    TraceRecorder(const std::string& tracePath);
+
+    // Destrutor: fecha o arquivo de trace
+    ~TraceRecorder();
+
+    // Registra a geometria do volume formatado no cabeçalho
+    void recordFormat(uint32_t totalSectors, uint16_t rootEntryCount, uint8_t sectorsPerCluster, uint8_t stripeCount);
+
+    // Registra uma operação iniciada no instante timestamp
+    void record(uint8_t op, const std::string& fileName, uint32_t size, bool success, uint64_t timestamp);
+
+    // Obtém o instante atual em microssegundos desde o início da gravação
+    uint64_t now() const;
+
+    // Carrega um arquivo de trace completo
+    static bool load(const std::string& tracePath, TraceHeader& header, std::vector<TraceRecord>& records);
+
+private:
+    FILE* file;                                   // Arquivo de trace
+    TraceHeader header;                           // Cabeçalho do trace
+    std::chrono::steady_clock::time_point start;  // Início da gravação
+};
+
+// Registra uma operação ao sair do escopo; não faz nada se não houver gravador
+class TraceScope {
+public:
+    // Construtor: marca o instante de início da operação
+    TraceScope(TraceRecorder* recorder, uint8_t op, const std::string& fileName);
+
+    // Destrutor: grava o registro da operação
+    ~TraceScope();
+
+    uint32_t size;   // Bytes copiados pela operação
+    bool success;    // A operação foi concluída com sucesso
+
+private:
+    TraceRecorder* recorder;
+    uint8_t op;
+    std::string fileName;
+    uint64_t timestamp;
+};
+
+#endif // TRACE_RECORDER_H
\ No newline at end of file
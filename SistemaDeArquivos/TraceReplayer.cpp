@@ -0,0 +1,173 @@
+#include "TraceReplayer.h"
+#include "FileSystem.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// Construtor: carrega o arquivo de trace
+TraceReplayer::TraceReplayer(const std::string& tracePath) {
+    if (!TraceRecorder::load(tracePath, header, records)) {
+        throw std::runtime_error("Erro ao carregar o arquivo de trace!");
+    }
+}
+
+// Gera um arquivo de origem com o tamanho gravado para uma cópia para o sistema
+static void writeSourceFile(const std::string& path, uint32_t size) {
+    std::vector<char> data(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        data[i] = 'a' + i % 26;
+    }
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    outFile.write(data.data(), size);
+}
+
+// Executa o trace em uma imagem nova e mostra vazão, latências e fragmentação final
+bool TraceReplayer::replay(const std::string& diskPath, bool originalTiming, uint32_t threadCount) {
+    if (header.totalSectors == 0) {
+        std::cerr << "O trace não registrou a formatação do volume!" << std::endl;
+        return false;
+    }
+    threadCount = std::max<uint32_t>(1, threadCount);
+
+    // Criar uma imagem nova com a mesma geometria do volume gravado
+    std::vector<std::string> stripePaths;
+    for (uint32_t i = 0; i < header.stripeCount; ++i) {
+        stripePaths.push_back(diskPath + "." + std::to_string(i));
+    }
+    FileSystem fs(diskPath, stripePaths);
+    if (!fs.format(header.totalSectors, header.rootEntryCount, header.sectorsPerCluster)) {
+        std::cerr << "Falha na formatação." << std::endl;
+        return false;
+    }
+
+    // Dividir as operações entre as threads pelo nome do arquivo, preservando a ordem de cada arquivo
+    std::vector<std::vector<size_t>> queues(threadCount);
+    std::hash<std::string> hasher;
+    for (size_t i = 0; i < records.size(); ++i) {
+        std::string fileName(records[i].fileName, strnlen(records[i].fileName, 16));
+        queues[hasher(fileName) % threadCount].push_back(i);
+    }
+
+    // Silenciar as mensagens do sistema de arquivos durante a execução
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+    std::streambuf* cerrBuffer = std::cerr.rdbuf(nullptr);
+
+    std::mutex fsMutex; // O FileSystem não é thread-safe: uma operação por vez
+    std::vector<std::vector<uint64_t>> latencies(threadCount);
+    std::vector<uint64_t> bytes(threadCount, 0);
+    std::vector<uint32_t> mismatches(threadCount, 0);
+    std::vector<uint32_t> skipped(threadCount, 0);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            std::string sourcePath = diskPath + ".replay_src_" + std::to_string(t);
+            std::string destPath = diskPath + ".replay_out_" + std::to_string(t);
+            for (size_t index : queues[t]) {
+                const TraceRecord& record = records[index];
+
+                // Uma cópia que falhou na gravação não tem o tamanho do arquivo de origem: não há como repeti-la
+                if (record.op == TRACE_PUT && record.success == 0) {
+                    ++skipped[t];
+                    continue;
+                }
+
+                if (originalTiming) {
+                    std::this_thread::sleep_until(start + std::chrono::microseconds(record.timestamp));
+                }
+                std::string fileName(record.fileName, strnlen(record.fileName, 16));
+
+                // Preparar o arquivo de origem fora da medição
+                if (record.op == TRACE_PUT) {
+                    writeSourceFile(sourcePath, record.size);
+                }
+
+                auto opStart = std::chrono::steady_clock::now();
+                bool success = true;
+                {
+                    std::lock_guard<std::mutex> lock(fsMutex);
+                    switch (record.op) {
+                        case TRACE_PUT:
+                            success = fs.copyToSystem(sourcePath, fileName);
+                            break;
+                        case TRACE_GET:
+                            success = fs.copyFromSystem(fileName, destPath);
+                            break;
+                        case TRACE_RM:
+                            success = fs.removeFile(fileName);
+                            break;
+                        case TRACE_LS:
+                            fs.listFiles();
+                            break;
+                    }
+                }
+                auto opEnd = std::chrono::steady_clock::now();
+                latencies[t].push_back(std::chrono::duration_cast<std::chrono::microseconds>(opEnd - opStart).count());
+
+                if (success && (record.op == TRACE_PUT || record.op == TRACE_GET)) {
+                    bytes[t] += record.size;
+                }
+                if (success != (record.success != 0)) {
+                    ++mismatches[t]; // Resultado diferente do gravado
+                }
+            }
+            remove(sourcePath.c_str());
+            remove(destPath.c_str());
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout.rdbuf(coutBuffer);
+    std::cerr.rdbuf(cerrBuffer);
+
+    // Juntar os resultados das threads
+    std::vector<uint64_t> allLatencies;
+    uint64_t totalBytes = 0;
+    uint32_t totalMismatches = 0;
+    uint32_t totalSkipped = 0;
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        allLatencies.insert(allLatencies.end(), latencies[t].begin(), latencies[t].end());
+        totalBytes += bytes[t];
+        totalMismatches += mismatches[t];
+        totalSkipped += skipped[t];
+    }
+    std::sort(allLatencies.begin(), allLatencies.end());
+    auto percentile = [&allLatencies](double p) -> uint64_t {
+        if (allLatencies.empty()) {
+            return 0;
+        }
+        size_t rank = static_cast<size_t>(p * allLatencies.size() + 0.999999); // Posição pelo método nearest-rank
+        return allLatencies[std::min(allLatencies.size(), std::max<size_t>(1, rank)) - 1];
+    };
+
+    // Mostrar o relatório
+    double seconds = std::max(elapsed, 1e-9);
+    size_t executed = records.size() - totalSkipped;
+    std::cout << "Operações: " << executed
+              << " (resultados diferentes do gravado: " << totalMismatches
+              << ", cópias com falha na gravação ignoradas: " << totalSkipped << ")" << std::endl;
+    std::cout << "Tempo total: " << elapsed << " s" << std::endl;
+    std::cout << "Vazão: " << executed / seconds << " op/s, "
+              << totalBytes / seconds / (1024.0 * 1024.0) << " MB/s" << std::endl;
+    std::cout << "Latência (us): p50 " << percentile(0.50)
+              << ", p95 " << percentile(0.95)
+              << ", p99 " << percentile(0.99)
+              << ", máx " << (allLatencies.empty() ? 0 : allLatencies.back()) << std::endl;
+
+    FragmentationStats fragmentation = fs.getFragmentation();
+    std::cout << "Fragmentação final: " << fragmentation.fragmentedFiles << " de " << fragmentation.chainedFiles
+              << " arquivos em cadeia fragmentados, "
+              << (fragmentation.chainedFiles ? static_cast<double>(fragmentation.extents) / fragmentation.chainedFiles : 0.0)
+              << " sequências por arquivo, " << fragmentation.freeRuns << " sequências livres" << std::endl;
+
+    return true;
+}
\ No newline at end of file
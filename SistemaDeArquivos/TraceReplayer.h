@@ -0,0 +1,24 @@
+#ifndef TRACE_REPLAYER_H
+#define TRACE_REPLAYER_H
+
+#include "TraceRecorder.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TraceReplayer {
+public:
+    // Construtor: carrega o arquivo de trace
+    TraceReplayer(const std::string& tracePath);
+
+    // Executa o trace em uma imagem nova e mostra vazão, latências e fragmentação final
+    // originalTiming: respeita os instantes gravados; caso contrário, executa na velocidade máxima
+    // threadCount: as operações são divididas entre as threads pelo nome do arquivo
+    bool replay(const std::string& diskPath, bool originalTiming, uint32_t threadCount);
+
+private:
+    TraceHeader header;                // Geometria do volume gravado
+    std::vector<TraceRecord> records;  // Operações gravadas, em ordem
+};
+
+#endif // TRACE_REPLAYER_H
\ No newline at end of file